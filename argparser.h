@@ -28,7 +28,8 @@ extern "C" {
     X(U8,       "uint8_t") \
     X(I8,       "int8_t") \
     X(BOOL,     "bool") \
-    X(STRING,   "const char *")
+    X(STRING,   "const char *") \
+    X(MAP,      "map")
 
     typedef enum {
     #define X(name, str) ARG_TYPE_##name,
@@ -63,6 +64,126 @@ extern "C" {
         char* str;
     } arg_value;
 
+    typedef struct {
+        const char* key;
+        size_t key_len;
+        const char* value;
+        uint64_t hash;
+    } arg_map_entry_t;
+
+    typedef struct {
+        // NOTE: keys and values point straight into these tokens, split at the first '=' without copying.
+        // keys are therefore not null terminated, use `key_len`
+        char** tokens;
+        arg_map_entry_t* entries;
+        size_t length;
+        size_t capacity;
+
+        // open addressing with linear probing, each slot holds an entry index + 1 so that 0 means empty
+        uint32_t* slots;
+        size_t slots_capacity;
+    } arg_map_t;
+
+    uint64_t arg_map_hash( const char* key, size_t key_len ) {
+        uint64_t hash = 14695981039346656037ULL;
+        for ( size_t i = 0; i < key_len; i++ ) {
+            hash ^= (uint8_t)key[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    size_t arg_map_find( const arg_map_t* map, const char* key, size_t key_len, uint64_t hash ) {
+        if ( !map->slots_capacity ) {
+            return (size_t)-1;
+        }
+
+        size_t mask = map->slots_capacity - 1;
+        for ( size_t slot = hash & mask; map->slots[slot]; slot = ( slot + 1 ) & mask ) {
+            const arg_map_entry_t* entry = &map->entries[map->slots[slot] - 1];
+            if ( entry->hash == hash && entry->key_len == key_len && !memcmp( entry->key, key, key_len ) ) {
+                return map->slots[slot] - 1;
+            }
+        }
+        return (size_t)-1;
+    }
+
+    // NOTE: `token` must contain a '='. the map only takes ownership of it when `owned` is set,
+    // returns false without inserting if the key is already present
+    bool arg_map_insert( arg_map_t* map, char* token, bool owned ) {
+        size_t key_len = (size_t)( strchr( token, '=' ) - token );
+        uint64_t hash = arg_map_hash( token, key_len );
+        if ( arg_map_find( map, token, key_len, hash ) != (size_t)-1 ) {
+            return false;
+        }
+
+        if ( map->length == map->capacity ) {
+            map->capacity = map->capacity ? map->capacity << 1 : 8;
+
+            arg_map_entry_t* entries = (arg_map_entry_t*)realloc( map->entries, map->capacity * sizeof( arg_map_entry_t ) );
+            if ( !entries ) {
+                fprintf( stderr, "[FATAL]: could not reallocate memory for `arg_map_t.entries`\n" );
+                exit( EXIT_FAILURE );
+            }
+            map->entries = entries;
+
+            char** tokens = (char**)realloc( map->tokens, map->capacity * sizeof( char* ) );
+            if ( !tokens ) {
+                fprintf( stderr, "[FATAL]: could not reallocate memory for `arg_map_t.tokens`\n" );
+                exit( EXIT_FAILURE );
+            }
+            map->tokens = tokens;
+        }
+
+        if ( ( map->length + 1 ) * 2 > map->slots_capacity ) {
+            size_t slots_capacity = map->slots_capacity ? map->slots_capacity << 1 : 16;
+            uint32_t* slots = (uint32_t*)calloc( slots_capacity, sizeof( uint32_t ) );
+            if ( !slots ) {
+                fprintf( stderr, "[FATAL]: could not allocate memory for `arg_map_t.slots`\n" );
+                exit( EXIT_FAILURE );
+            }
+
+            for ( size_t i = 0; i < map->length; i++ ) {
+                size_t slot = map->entries[i].hash & ( slots_capacity - 1 );
+                while ( slots[slot] ) {
+                    slot = ( slot + 1 ) & ( slots_capacity - 1 );
+                }
+                slots[slot] = (uint32_t)( i + 1 );
+            }
+
+            free( map->slots );
+            map->slots = slots;
+            map->slots_capacity = slots_capacity;
+        }
+
+        size_t slot = hash & ( map->slots_capacity - 1 );
+        while ( map->slots[slot] ) {
+            slot = ( slot + 1 ) & ( map->slots_capacity - 1 );
+        }
+        map->slots[slot] = (uint32_t)( map->length + 1 );
+
+        map->entries[map->length].key = token;
+        map->entries[map->length].key_len = key_len;
+        map->entries[map->length].value = token + key_len + 1;
+        map->entries[map->length].hash = hash;
+        map->tokens[map->length] = owned ? token : NULL;
+        map->length += 1;
+        return true;
+    }
+
+    void arg_map_free( arg_map_t* map ) {
+        if ( map->tokens ) {
+            for ( size_t i = 0; i < map->length; i++ ) {
+                free( map->tokens[i] );
+            }
+            free( map->tokens );
+        }
+
+        free( map->entries );
+        free( map->slots );
+        memset( map, 0, sizeof( arg_map_t ) );
+    }
+
     typedef struct {
         struct {
             char* identifier;
@@ -75,7 +196,12 @@ extern "C" {
 
         bool found;
         arg_value* values;
+        // NOTE: raw argv tokens behind `values`, kept so `argparser_reparse` can diff against them
+        char** tokens;
         size_t values_len;
+
+        // only used by ARG_TYPE_MAP, where `values_len` is the number of `key=value` tokens per occurrence
+        arg_map_t map;
     } arg_t;
 
 
@@ -100,12 +226,16 @@ extern "C" {
         arg->meta.required = false;
         arg->found = false;
 
-        if ( arg->meta.type == ARG_TYPE_STRING ) {
+        if ( arg->tokens ) {
             for ( size_t i = 0; i < arg->values_len; i++ ) {
-                free( arg->values[i].str );
+                free( arg->tokens[i] );
             }
+            free( arg->tokens );
+            arg->tokens = NULL;
         }
 
+        arg_map_free( &arg->map );
+
         if ( arg->values ) {
             arg->values_len = 0;
             free( arg->values );
@@ -248,15 +378,24 @@ extern "C" {
         arg.meta.type = type;
         arg.values_len = arg_count;
         arg.found = false;
+        memset( &arg.map, 0, sizeof( arg_map_t ) );
 
-        if ( arg.values_len > 0 ) {
+        // NOTE: map entries live in `arg.map`, so maps never use `values` or `tokens`
+        if ( arg.values_len > 0 && type != ARG_TYPE_MAP ) {
             arg.values = (arg_value*)calloc( arg.values_len, sizeof( arg_value ) );
             if ( !arg.values ) {
                 fprintf( stderr, "[FATAL]: could not allocate memory for `arg.values`\n" );
                 exit( EXIT_FAILURE );
             }
+
+            arg.tokens = (char**)calloc( arg.values_len, sizeof( char* ) );
+            if ( !arg.tokens ) {
+                fprintf( stderr, "[FATAL]: could not allocate memory for `arg.tokens`\n" );
+                exit( EXIT_FAILURE );
+            }
         } else {
             arg.values = NULL;
+            arg.tokens = NULL;
         }
 
         arg.meta.description = strdup( description );
@@ -363,31 +502,107 @@ extern "C" {
         }
     }
 
-    int argparser_parse( argparser_inner_t* argparser, int argc, char** argv ) {
+    size_t argparser_find_alias( argparser_inner_t* argparser, const char* token ) {
+        for ( size_t j = 0; j < argparser->args_length; j++ ) {
+            for ( size_t k = 0; k < argparser->args[j].meta.aliases_len; k++ ) {
+                if ( !strcmp( argparser->args[j].meta.aliases[k], token ) ) {
+                    return j;
+                }
+            }
+        }
+        return (size_t)-1;
+    }
 
-        for ( size_t i = 1; i < argc; i++ ) {
-            bool found = false;
-            size_t index = (size_t)-1;
-            for ( size_t j = 0; j < argparser->args_length; j++ ) {
-                for ( size_t k = 0; k < argparser->args[j].meta.aliases_len; k++ ) {
-                    if ( !strcmp( argparser->args[j].meta.aliases[k], argv[i] ) ) {
-                        found = true;
-                        index = j;
-                        break;
-                    }
+    // NOTE: ARG_TYPE_STRING values borrow `token` rather than copying it, the caller decides who owns it
+    bool arg_value_convert( arg_type type, const char* token, arg_value* value ) {
+        char* end = NULL;
+
+        switch ( type ) {
+        case ARG_TYPE_NONE:
+        case ARG_TYPE_MAP: {
+                assert( 0 && "unreachable" );
+                return false;
+            }
+        case ARG_TYPE_U64: {
+                value->u64 = strtoull( token, &end, 10 );
+                break;
+            }
+        case ARG_TYPE_I64: {
+                value->i64 = strtoll( token, &end, 10 );
+                break;
+            }
+        case ARG_TYPE_F64: {
+                value->f64 = strtod( token, &end );
+                break;
+            }
+        case ARG_TYPE_U32: {
+                value->u32 = (uint32_t)strtoull( token, &end, 10 );
+                break;
+            }
+        case ARG_TYPE_I32: {
+                value->i32 = (int32_t)strtoll( token, &end, 10 );
+                break;
+            }
+        case ARG_TYPE_F32: {
+                value->f32 = strtof( token, &end );
+                break;
+            }
+        case ARG_TYPE_U16: {
+                value->u16 = (uint16_t)strtoull( token, &end, 10 );
+                break;
+            }
+        case ARG_TYPE_I16: {
+                value->i16 = (int16_t)strtoll( token, &end, 10 );
+                break;
+            }
+        case ARG_TYPE_U8: {
+                value->u8 = (uint8_t)token[0];
+                return true;
+            }
+        case ARG_TYPE_I8: {
+                value->i8 = (int8_t)token[0];
+                return true;
+            }
+        case ARG_TYPE_BOOL: {
+                if ( !strcmp( token, "true" ) ) {
+                    value->b = true;
+                } else if ( !strcmp( token, "false" ) ) {
+                    value->b = false;
+                } else {
+                    return false;
                 }
+                return true;
+            }
+        case ARG_TYPE_STRING: {
+                value->str = (char*)token;
+                return true;
+            }
 
-                if ( found == true ) {
-                    if ( !strcmp( argparser->args[index].meta.identifier, "--help" ) || !strcmp( argparser->args[index].meta.identifier, "-h" ) ) {
-                        argparser_print_usage( argparser );
-                        exit( EXIT_SUCCESS );
-                    }
-                    break;
+        default: {
+                fprintf( stderr, "[FATAL]: unhandled argument of type %d\n", type );
+                exit( EXIT_FAILURE );
+            }
+        }
+
+        return end != NULL && *end == '\0';
+    }
+
+    int argparser_parse( argparser_inner_t* argparser, int argc, char** argv ) {
+
+        for ( int i = 1; i < argc; i++ ) {
+            size_t index = argparser_find_alias( argparser, argv[i] );
+            bool found = index != (size_t)-1;
+
+            if ( found == true ) {
+                if ( !strcmp( argparser->args[index].meta.identifier, "--help" ) || !strcmp( argparser->args[index].meta.identifier, "-h" ) ) {
+                    argparser_print_usage( argparser );
+                    exit( EXIT_SUCCESS );
                 }
             }
+
             if ( !found ) {
                 if ( argv[i][0] == '-' ) {
-                    fprintf( stderr, "[ERROR]: unknown argument `%s` at position `%zu`\n", argv[i], i );
+                    fprintf( stderr, "[ERROR]: unknown argument `%s` at position `%d`\n", argv[i], i );
                     argparser_free( argparser );
                     return 1;
                 } else if ( argparser->argv_capacity == 0 ) {
@@ -397,7 +612,7 @@ extern "C" {
                         fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.argv\n" );
                         exit( EXIT_FAILURE );
                     }
-                } else if ( argparser->argc == argparser->argv_capacity ) {
+                } else if ( argparser->argv_length == argparser->argv_capacity ) {
                     argparser->argv_capacity <<= 1;
                     char** reallocation = (char**)realloc( argparser->argv, argparser->argv_capacity * sizeof( char* ) );
                     if ( !reallocation ) {
@@ -410,11 +625,47 @@ extern "C" {
                 argparser->argv[argparser->argc] = strdup( argv[i] );
                 if ( !argparser->argv[argparser->argc] ) {
                     fprintf( stderr, "[FATAL]: could not duplicate string for argparser_inner_t.argv\n" );
+                    exit( EXIT_FAILURE );
                 }
                 argparser->argc += 1;
+                argparser->argv_length += 1;
+
+            } else if ( argparser->args[index].meta.type == ARG_TYPE_MAP ) {
+                // NOTE: maps are the only arguments that can be repeated, every occurrence adds more entries
+                for ( size_t j = 0; j < argparser->args[index].values_len; j++ ) {
+                    if ( i + j + 1 >= (size_t)argc ) {
+                        fprintf( stderr, "[FATAL]: missing value for argument `%s` at position %zu\n", argparser->args[index].meta.identifier, i + j + 1 );
+                        argparser_print_usage( argparser );
+                        argparser_free( argparser );
+                        return 1;
+                    }
+
+                    if ( !strchr( argv[i + j + 1], '=' ) ) {
+                        fprintf( stderr, "[FATAL]: expected `key=value` for argument `%s` at position %zu\n", argparser->args[index].meta.identifier, i + j + 1 );
+                        argparser_print_usage( argparser );
+                        argparser_free( argparser );
+                        return 1;
+                    }
+
+                    char* token = strdup( argv[i + j + 1] );
+                    if ( !token ) {
+                        fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.args[%zu].map.tokens\n", index );
+                        exit( EXIT_FAILURE );
+                    }
+
+                    if ( !arg_map_insert( &argparser->args[index].map, token, true ) ) {
+                        fprintf( stderr, "[ERROR]: duplicate key in `%s` for argument `%s` at position %zu\n", token, argparser->args[index].meta.identifier, i + j + 1 );
+                        free( token );
+                        argparser_free( argparser );
+                        return 1;
+                    }
+                }
+
+                i += (int)argparser->args[index].values_len;
+                argparser->args[index].found = true;
 
             } else if ( argparser->args[index].found ) {
-                fprintf( stderr, "[ERROR]: redefinition of argument `%s` at position `%zu`\n", argparser->args[index].meta.identifier, i );
+                fprintf( stderr, "[ERROR]: redefinition of argument `%s` at position `%d`\n", argparser->args[index].meta.identifier, i );
                 argparser_free( argparser );
                 return 1;
 
@@ -423,101 +674,34 @@ extern "C" {
 
             } else {
                 for ( size_t j = 0; j < argparser->args[index].values_len; j++ ) {
-                    if ( i + j + 1 >= argc ) {
+                    if ( i + j + 1 >= (size_t)argc ) {
                         fprintf( stderr, "[FATAL]: missing value for argument `%s` at position %zu\n", argparser->args[index].meta.identifier, i + j + 1 );
                         argparser_print_usage( argparser );
                         argparser_free( argparser );
                         return 1;
                     }
-                    char* end = NULL;
 
-                    switch ( argparser->args[index].meta.type ) {
-                    case ARG_TYPE_NONE: {
-                            assert( 0 && "unreachable" );
-                            break;
-                        }
-                    case ARG_TYPE_U64: {
-                            argparser->args[index].values[j].u64 = strtoull( argv[i + j + 1], &end, 10 );
-                            break;
-                        }
-                    case ARG_TYPE_I64: {
-                            argparser->args[index].values[j].i64 = strtoll( argv[i + j + 1], &end, 10 );
-                            break;
-                        }
-                    case ARG_TYPE_F64: {
-                            argparser->args[index].values[j].f64 = strtod( argv[i + j + 1], &end );
-                            break;
-                        }
-                    case ARG_TYPE_U32: {
-                            argparser->args[index].values[j].u32 = (uint32_t)strtoull( argv[i + j + 1], &end, 10 );
-                            break;
-                        }
-                    case ARG_TYPE_I32: {
-                            argparser->args[index].values[j].i32 = (int32_t)strtoll( argv[i + j + 1], &end, 10 );
-                            break;
-                        }
-                    case ARG_TYPE_F32: {
-                            argparser->args[index].values[j].f32 = strtof( argv[i + j + 1], &end );
-                            break;
-                        }
-                    case ARG_TYPE_U16: {
-                            argparser->args[index].values[j].u16 = (uint16_t)strtoull( argv[i + j + 1], &end, 10 );
-                            break;
-                        }
-                    case ARG_TYPE_I16: {
-                            argparser->args[index].values[j].i16 = (int16_t)strtoll( argv[i + j + 1], &end, 10 );
-                            break;
-                        }
-                    case ARG_TYPE_U8: {
-                            argparser->args[index].values[j].u8 = (uint8_t)argv[i + j + 1][0];
-                            break;
-                        }
-                    case ARG_TYPE_I8: {
-                            argparser->args[index].values[j].i8 = (int8_t)argv[i + j + 1][0];
-                            break;
-                        }
-                    case ARG_TYPE_BOOL: {
-                            if ( !strcmp( argv[i + j + 1], "true" ) ) {
-                                argparser->args[index].values[j].b = true;
-                            } else if ( !strcmp( argv[i + j + 1], "false" ) ) {
-                                argparser->args[index].values[j].b = false;
-                            } else {
-                                fprintf( stderr, "[FATAL]: invalid boolean value `%s` at position %zu\n", argv[i + j + 1], i + j + 1 );
-                                argparser_free( argparser );
-                                return 1;
-                            }
-                            break;
-                        }
-                    case ARG_TYPE_STRING: {
-                            argparser->args[index].values[j].str = strdup( argv[i + j + 1] );
-                            if ( !argparser->args[index].values[j].str ) {
-                                fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.args[%zu].values[%zu].str\n", index, j );
-                                exit( EXIT_FAILURE );
-                            }
-                            break;
-                        }
-
-                    default: {
-                            fprintf( stderr, "[FATAL]: unhandled argument of type %d\n", argparser->args[index].meta.type );
-                            exit( EXIT_FAILURE );
-                        }
+                    argparser->args[index].tokens[j] = strdup( argv[i + j + 1] );
+                    if ( !argparser->args[index].tokens[j] ) {
+                        fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.args[%zu].tokens[%zu]\n", index, j );
+                        exit( EXIT_FAILURE );
                     }
 
-                    // NOTE(hamid): these types don't use char* end, so we can just skip over this check for them
-                    if ( argparser->args[index].meta.type != ARG_TYPE_STRING &&
-                        argparser->args[index].meta.type != ARG_TYPE_BOOL &&
-                        argparser->args[index].meta.type != ARG_TYPE_U8 &&
-                        argparser->args[index].meta.type != ARG_TYPE_I8 ) {
-                        if ( end == NULL || *end != '\0' ) {
-                            fprintf( stderr, "[FATAL]: invalid argument at position %zu\n", i + j + 1 );
-                            argparser_print_usage( argparser );
+                    if ( !arg_value_convert( argparser->args[index].meta.type, argparser->args[index].tokens[j], &argparser->args[index].values[j] ) ) {
+                        if ( argparser->args[index].meta.type == ARG_TYPE_BOOL ) {
+                            fprintf( stderr, "[FATAL]: invalid boolean value `%s` at position %zu\n", argv[i + j + 1], i + j + 1 );
                             argparser_free( argparser );
                             return 1;
                         }
+
+                        fprintf( stderr, "[FATAL]: invalid argument at position %zu\n", i + j + 1 );
+                        argparser_print_usage( argparser );
+                        argparser_free( argparser );
+                        return 1;
                     }
                 }
 
-                i += argparser->args[index].values_len;
+                i += (int)argparser->args[index].values_len;
                 argparser->args[index].found = true;
             }
         }
@@ -533,6 +717,399 @@ extern "C" {
         return 0;
     }
 
+    typedef struct {
+        size_t index;
+        arg_type type;
+        size_t values_len;
+
+        bool old_found;
+        arg_value* old_values;
+        // NOTE: tokens that were carried over unchanged are NULL here, since the argument owns them again
+        char** old_tokens;
+
+        bool new_found;
+        arg_value* new_values;
+
+        // NOTE: only set for ARG_TYPE_MAP, whose `old_values` and `new_values` are left NULL
+        arg_map_t old_map;
+        arg_map_t* new_map;
+    } arg_change_t;
+
+    typedef struct {
+        // one bit per `argparser_inner_t.args` index
+        uint64_t* changed;
+        size_t changed_words;
+
+        arg_change_t* changes;
+        size_t changes_length;
+
+        bool positionals_changed;
+    } argparser_changes_t;
+
+    void argparser_changes_free( argparser_changes_t* changes ) {
+        if ( changes->changes ) {
+            for ( size_t i = 0; i < changes->changes_length; i++ ) {
+                if ( changes->changes[i].old_tokens ) {
+                    for ( size_t j = 0; j < changes->changes[i].values_len; j++ ) {
+                        free( changes->changes[i].old_tokens[j] );
+                    }
+                    free( changes->changes[i].old_tokens );
+                }
+
+                if ( changes->changes[i].old_values ) {
+                    free( changes->changes[i].old_values );
+                }
+
+                arg_map_free( &changes->changes[i].old_map );
+            }
+            free( changes->changes );
+            changes->changes = NULL;
+        }
+        changes->changes_length = 0;
+
+        if ( changes->changed ) {
+            free( changes->changed );
+            changes->changed = NULL;
+        }
+        changes->changed_words = 0;
+        changes->positionals_changed = false;
+    }
+
+    void argparser_reparse_staging_free(
+        argparser_inner_t* argparser,
+        size_t* positions,
+        size_t* owners,
+        char** positionals,
+        uint64_t* changed,
+        arg_value** staged,
+        arg_map_t* staged_maps
+    ) {
+        if ( staged ) {
+            for ( size_t i = 0; i < argparser->args_length; i++ ) {
+                free( staged[i] );
+            }
+            free( staged );
+        }
+
+        if ( staged_maps ) {
+            for ( size_t i = 0; i < argparser->args_length; i++ ) {
+                arg_map_free( &staged_maps[i] );
+            }
+            free( staged_maps );
+        }
+        free( changed );
+        free( owners );
+        free( positionals );
+        free( positions );
+    }
+
+    // NOTE: unlike `argparser_parse`, a failed reparse leaves the parser and its previous values untouched,
+    // since a long running program still needs its old configuration. only arguments whose tokens differ from the
+    // previous parse get reconverted, and unchanged tokens are reused rather than duplicated again.
+    // `changes` may be NULL. otherwise it is overwritten, so free the previous change set first.
+    // string values in `changes` stay valid until the next reparse or `argparser_free`.
+    // `argv` may alias strings the parser owns, e.g. ones returned by `argparser_get_str`
+    int argparser_reparse( argparser_inner_t* argparser, int argc, char** argv, argparser_changes_t* changes ) {
+        // NOTE: without a change set the old values still go into a local one, since `argv` may point into them
+        // and they can only be freed once nothing reads from `argv` anymore
+        argparser_changes_t discarded;
+        argparser_changes_t* sink = changes ? changes : &discarded;
+        memset( sink, 0, sizeof( argparser_changes_t ) );
+
+        size_t* positions = (size_t*)malloc( argparser->args_length * sizeof( size_t ) );
+        char** positionals = (char**)calloc( argc > 0 ? argc : 1, sizeof( char* ) );
+        size_t changed_words = ( argparser->args_length + 63 ) / 64;
+        uint64_t* changed = (uint64_t*)calloc( changed_words, sizeof( uint64_t ) );
+        arg_value** staged = (arg_value**)calloc( argparser->args_length, sizeof( arg_value* ) );
+        // NOTE: which argument each value token belongs to, maps need this since they can be repeated
+        size_t* owners = (size_t*)malloc( ( argc > 0 ? argc : 1 ) * sizeof( size_t ) );
+        arg_map_t* staged_maps = (arg_map_t*)calloc( argparser->args_length, sizeof( arg_map_t ) );
+        if ( !positions || !positionals || !changed || !staged || !owners || !staged_maps ) {
+            fprintf( stderr, "[FATAL]: could not allocate memory for argparser_reparse staging\n" );
+            exit( EXIT_FAILURE );
+        }
+
+        for ( size_t i = 0; i < argparser->args_length; i++ ) {
+            positions[i] = (size_t)-1;
+        }
+
+        for ( int i = 0; i < argc; i++ ) {
+            owners[i] = (size_t)-1;
+        }
+
+        size_t positionals_length = 0;
+        for ( int i = 1; i < argc; i++ ) {
+            size_t index = argparser_find_alias( argparser, argv[i] );
+
+            if ( index == (size_t)-1 ) {
+                if ( argv[i][0] == '-' ) {
+                    fprintf( stderr, "[ERROR]: unknown argument `%s` at position `%d`\n", argv[i], i );
+                    argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+                    return 1;
+                }
+                positionals[positionals_length] = argv[i];
+                positionals_length += 1;
+
+            } else if ( positions[index] != (size_t)-1 && argparser->args[index].meta.type != ARG_TYPE_MAP ) {
+                fprintf( stderr, "[ERROR]: redefinition of argument `%s` at position `%d`\n", argparser->args[index].meta.identifier, i );
+                argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+                return 1;
+
+            } else if ( i + argparser->args[index].values_len >= (size_t)argc && argparser->args[index].values_len ) {
+                fprintf( stderr, "[FATAL]: missing value for argument `%s` at position %d\n", argparser->args[index].meta.identifier, argc );
+                argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+                return 1;
+
+            } else {
+                if ( positions[index] == (size_t)-1 ) {
+                    positions[index] = (size_t)i + 1;
+                }
+
+                for ( size_t j = 0; j < argparser->args[index].values_len; j++ ) {
+                    owners[i + j + 1] = index;
+                }
+                i += (int)argparser->args[index].values_len;
+            }
+        }
+
+        for ( size_t i = 0; i < argparser->args_length; i++ ) {
+            arg_t* arg = &argparser->args[i];
+            bool found = positions[i] != (size_t)-1;
+
+            if ( !found && arg->meta.required ) {
+                fprintf( stderr, "[FATAL]: missing required argument `%s`\n", arg->meta.identifier );
+                argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+                return 1;
+            }
+
+            if ( arg->meta.type == ARG_TYPE_MAP ) {
+                bool differs = found != arg->found;
+                size_t length = 0;
+                for ( int t = 1; t < argc && !differs; t++ ) {
+                    if ( owners[t] != i ) {
+                        continue;
+                    }
+
+                    differs = length >= arg->map.length || strcmp( arg->map.tokens[length], argv[t] );
+                    length += 1;
+                }
+
+                // NOTE: an unchanged token list was already validated when it was last parsed, so it costs nothing
+                if ( !differs && length == arg->map.length ) {
+                    continue;
+                }
+                changed[i / 64] |= (uint64_t)1 << ( i % 64 );
+
+                for ( int t = 1; t < argc; t++ ) {
+                    if ( owners[t] != i ) {
+                        continue;
+                    }
+
+                    if ( !strchr( argv[t], '=' ) ) {
+                        fprintf( stderr, "[FATAL]: expected `key=value` for argument `%s` at position %d\n", arg->meta.identifier, t );
+                        argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+                        return 1;
+                    }
+
+                    if ( !arg_map_insert( &staged_maps[i], argv[t], false ) ) {
+                        fprintf( stderr, "[ERROR]: duplicate key in `%s` for argument `%s` at position %d\n", argv[t], arg->meta.identifier, t );
+                        argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+                        return 1;
+                    }
+                }
+                continue;
+            }
+
+            bool differs = found != arg->found;
+            for ( size_t j = 0; found && !differs && j < arg->values_len; j++ ) {
+                differs = !arg->tokens[j] || strcmp( arg->tokens[j], argv[positions[i] + j] );
+            }
+
+            if ( !differs ) {
+                continue;
+            }
+            changed[i / 64] |= (uint64_t)1 << ( i % 64 );
+
+            if ( arg->values_len == 0 ) {
+                continue;
+            }
+
+            staged[i] = (arg_value*)calloc( arg->values_len, sizeof( arg_value ) );
+            if ( !staged[i] ) {
+                fprintf( stderr, "[FATAL]: could not allocate memory for argparser_reparse staged values\n" );
+                exit( EXIT_FAILURE );
+            }
+
+            for ( size_t j = 0; found && j < arg->values_len; j++ ) {
+                if ( !arg_value_convert( arg->meta.type, argv[positions[i] + j], &staged[i][j] ) ) {
+                    if ( arg->meta.type == ARG_TYPE_BOOL ) {
+                        fprintf( stderr, "[FATAL]: invalid boolean value `%s` at position %zu\n", argv[positions[i] + j], positions[i] + j );
+                    } else {
+                        fprintf( stderr, "[FATAL]: invalid argument at position %zu\n", positions[i] + j );
+                    }
+                    argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+                    return 1;
+                }
+            }
+        }
+
+        // NOTE: nothing past this point can fail gracefully, so it's safe to start committing
+        size_t changes_length = 0;
+        for ( size_t i = 0; i < changed_words; i++ ) {
+            for ( uint64_t word = changed[i]; word; word &= word - 1 ) {
+                changes_length += 1;
+            }
+        }
+
+        if ( changes_length ) {
+            sink->changes = (arg_change_t*)calloc( changes_length, sizeof( arg_change_t ) );
+            if ( !sink->changes ) {
+                fprintf( stderr, "[FATAL]: could not allocate memory for `argparser_changes_t.changes`\n" );
+                exit( EXIT_FAILURE );
+            }
+        }
+
+        for ( size_t i = 0; i < argparser->args_length; i++ ) {
+            if ( !( ( changed[i / 64] >> ( i % 64 ) ) & 1 ) ) {
+                continue;
+            }
+
+            arg_t* arg = &argparser->args[i];
+            bool found = positions[i] != (size_t)-1;
+
+            if ( arg->meta.type == ARG_TYPE_MAP ) {
+                arg_map_t* map = &staged_maps[i];
+                for ( size_t j = 0; j < map->length; j++ ) {
+                    // NOTE: look the key up in the old table so entries that only moved position are still reused
+                    const char* token = map->entries[j].key;
+                    size_t k = arg_map_find( &arg->map, token, map->entries[j].key_len, map->entries[j].hash );
+                    if ( k != (size_t)-1 && arg->map.tokens[k] && !strcmp( arg->map.tokens[k], token ) ) {
+                        map->tokens[j] = arg->map.tokens[k];
+                        arg->map.tokens[k] = NULL;
+                    } else {
+                        map->tokens[j] = strdup( token );
+                        if ( !map->tokens[j] ) {
+                            fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.args[%zu].map.tokens[%zu]\n", i, j );
+                            exit( EXIT_FAILURE );
+                        }
+                    }
+
+                    map->entries[j].key = map->tokens[j];
+                    map->entries[j].value = map->tokens[j] + map->entries[j].key_len + 1;
+                }
+
+                arg_change_t* change = &sink->changes[sink->changes_length];
+                change->index = i;
+                change->type = arg->meta.type;
+                change->values_len = arg->values_len;
+                change->old_found = arg->found;
+                change->old_map = arg->map;
+                change->new_found = found;
+                change->new_map = &arg->map;
+                sink->changes_length += 1;
+
+                arg->map = *map;
+                arg->found = found;
+                memset( map, 0, sizeof( arg_map_t ) );
+                continue;
+            }
+
+            arg_value* old_values = arg->values;
+            char** old_tokens = arg->tokens;
+            char** new_tokens = NULL;
+
+            if ( arg->values_len ) {
+                new_tokens = (char**)calloc( arg->values_len, sizeof( char* ) );
+                if ( !new_tokens ) {
+                    fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.args[%zu].tokens\n", i );
+                    exit( EXIT_FAILURE );
+                }
+            }
+
+            for ( size_t j = 0; found && j < arg->values_len; j++ ) {
+                const char* token = argv[positions[i] + j];
+                if ( old_tokens[j] && !strcmp( old_tokens[j], token ) ) {
+                    new_tokens[j] = old_tokens[j];
+                    old_tokens[j] = NULL;
+                } else {
+                    new_tokens[j] = strdup( token );
+                    if ( !new_tokens[j] ) {
+                        fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.args[%zu].tokens[%zu]\n", i, j );
+                        exit( EXIT_FAILURE );
+                    }
+                }
+
+                if ( arg->meta.type == ARG_TYPE_STRING ) {
+                    staged[i][j].str = new_tokens[j];
+                }
+            }
+
+            arg_change_t* change = &sink->changes[sink->changes_length];
+            change->index = i;
+            change->type = arg->meta.type;
+            change->values_len = arg->values_len;
+            change->old_found = arg->found;
+            change->old_values = old_values;
+            change->old_tokens = old_tokens;
+            change->new_found = found;
+            change->new_values = staged[i];
+            sink->changes_length += 1;
+
+            arg->values = staged[i];
+            arg->tokens = new_tokens;
+            arg->found = found;
+            staged[i] = NULL;
+        }
+
+        bool positionals_changed = positionals_length != argparser->argv_length;
+        for ( size_t i = 0; !positionals_changed && i < positionals_length; i++ ) {
+            positionals_changed = strcmp( argparser->argv[i], positionals[i] ) != 0;
+        }
+
+        if ( positionals_changed ) {
+            char** new_argv = (char**)calloc( positionals_length ? positionals_length : 1, sizeof( char* ) );
+            if ( !new_argv ) {
+                fprintf( stderr, "[FATAL]: could not allocate memory for argparser_inner_t.argv\n" );
+                exit( EXIT_FAILURE );
+            }
+
+            for ( size_t i = 0; i < positionals_length; i++ ) {
+                if ( i < argparser->argv_length && !strcmp( argparser->argv[i], positionals[i] ) ) {
+                    new_argv[i] = argparser->argv[i];
+                    argparser->argv[i] = NULL;
+                } else {
+                    new_argv[i] = strdup( positionals[i] );
+                    if ( !new_argv[i] ) {
+                        fprintf( stderr, "[FATAL]: could not duplicate string for argparser_inner_t.argv\n" );
+                        exit( EXIT_FAILURE );
+                    }
+                }
+            }
+
+            for ( size_t i = 0; i < argparser->argv_length; i++ ) {
+                free( argparser->argv[i] );
+            }
+            free( argparser->argv );
+
+            argparser->argv = new_argv;
+            argparser->argv_length = positionals_length;
+            argparser->argv_capacity = positionals_length ? positionals_length : 1;
+            argparser->argc = (int)positionals_length;
+        }
+
+        sink->changed = changed;
+        sink->changed_words = changed_words;
+        sink->positionals_changed = positionals_changed;
+        changed = NULL;
+
+        if ( !changes ) {
+            argparser_changes_free( &discarded );
+        }
+
+        argparser_reparse_staging_free( argparser, positions, owners, positionals, changed, staged, staged_maps );
+        return 0;
+    }
+
 #define DEFINE_ARGPARSER_GETTER(TYPE, FIELD, ENUM_TYPE)                                                         \
 TYPE argparser_get_##FIELD(argparser_inner_t* argparser, const char* identifier, size_t index) {                      \
     for (size_t i = 0; i < argparser->args_length; i++) {                                                       \
@@ -540,6 +1117,9 @@ TYPE argparser_get_##FIELD(argparser_inner_t* argparser, const char* identifier,
             if (index >= argparser->args[i].values_len) {                                                       \
                 fprintf(stderr, "[FATAL]: index %zu is out of range for argument %s\n", index, identifier);     \
                 exit(EXIT_FAILURE);                                                                             \
+            } else if (argparser->args[i].meta.type == ARG_TYPE_MAP) {                                          \
+                fprintf(stderr, "[FATAL]: getting " #FIELD " from map argument %s\n", identifier);             \
+                exit(EXIT_FAILURE);                                                                             \
             } else if (argparser->args[i].meta.type != ENUM_TYPE) {                                             \
                 fprintf(stderr, "[WARNING]: getting " #FIELD " from non-" #FIELD " argument %s\n", identifier); \
             }                                                                                                   \
@@ -585,6 +1165,88 @@ TYPE argparser_get_##FIELD(argparser_inner_t* argparser, const char* identifier,
         fprintf( stderr, "[FATAL]: argument %s not found\n", identifier );
         exit( EXIT_FAILURE );
     }
+
+    arg_map_t* argparser_get_map_inner( argparser_inner_t* argparser, const char* identifier ) {
+        for ( size_t i = 0; i < argparser->args_length; i++ ) {
+            if ( !strcmp( argparser->args[i].meta.identifier, identifier ) ) {
+                if ( argparser->args[i].meta.type != ARG_TYPE_MAP ) {
+                    fprintf( stderr, "[WARNING]: getting map from non-map argument %s\n", identifier );
+                }
+                return &argparser->args[i].map;
+            }
+        }
+        fprintf( stderr, "[FATAL]: argument %s not found\n", identifier );
+        exit( EXIT_FAILURE );
+    }
+
+    // returns NULL if `key` was never passed
+    const char* argparser_get_map( argparser_inner_t* argparser, const char* identifier, const char* key ) {
+        arg_map_t* map = argparser_get_map_inner( argparser, identifier );
+        size_t key_len = strlen( key );
+        size_t index = arg_map_find( map, key, key_len, arg_map_hash( key, key_len ) );
+        return index == (size_t)-1 ? NULL : map->entries[index].value;
+    }
+
+    // converts the value for `key` the same way a flag of `type` would be, returns false if it's missing or invalid
+    bool argparser_get_map_as( argparser_inner_t* argparser, const char* identifier, const char* key, arg_type type, arg_value* value ) {
+        if ( type == ARG_TYPE_NONE || type == ARG_TYPE_MAP ) {
+            fprintf( stderr, "[FATAL]: cannot convert map values to %s\n", arg_type_str[type] );
+            exit( EXIT_FAILURE );
+        }
+
+        const char* str = argparser_get_map( argparser, identifier, key );
+        if ( !str ) {
+            return false;
+        }
+
+        if ( !arg_value_convert( type, str, value ) ) {
+            fprintf( stderr, "[WARNING]: value `%s` for key `%s` in argument %s is not a valid %s\n", str, key, identifier, arg_type_str[type] );
+            return false;
+        }
+        return true;
+    }
+
+    size_t argparser_get_map_length( argparser_inner_t* argparser, const char* identifier ) {
+        return argparser_get_map_inner( argparser, identifier )->length;
+    }
+
+    // entries are kept in the order they were passed in
+    const arg_map_entry_t* argparser_get_map_entry( argparser_inner_t* argparser, const char* identifier, size_t index ) {
+        arg_map_t* map = argparser_get_map_inner( argparser, identifier );
+        if ( index >= map->length ) {
+            fprintf( stderr, "[FATAL]: index %zu is out of range for argument %s\n", index, identifier );
+            exit( EXIT_FAILURE );
+        }
+        return &map->entries[index];
+    }
+
+    bool argparser_changed( argparser_inner_t* argparser, argparser_changes_t* changes, const char* identifier ) {
+        for ( size_t i = 0; i < argparser->args_length; i++ ) {
+            if ( !strcmp( argparser->args[i].meta.identifier, identifier ) ) {
+                if ( i / 64 >= changes->changed_words ) {
+                    return false;
+                }
+                return ( changes->changed[i / 64] >> ( i % 64 ) ) & 1;
+            }
+        }
+        fprintf( stderr, "[FATAL]: argument %s not found\n", identifier );
+        exit( EXIT_FAILURE );
+    }
+
+    arg_change_t* argparser_get_change( argparser_inner_t* argparser, argparser_changes_t* changes, const char* identifier ) {
+        for ( size_t i = 0; i < argparser->args_length; i++ ) {
+            if ( !strcmp( argparser->args[i].meta.identifier, identifier ) ) {
+                for ( size_t j = 0; j < changes->changes_length; j++ ) {
+                    if ( changes->changes[j].index == i ) {
+                        return &changes->changes[j];
+                    }
+                }
+                return NULL;
+            }
+        }
+        fprintf( stderr, "[FATAL]: argument %s not found\n", identifier );
+        exit( EXIT_FAILURE );
+    }
 #undef DEFINE_ARGPARSER_GETTER
 
 #ifdef __cplusplus
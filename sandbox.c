@@ -44,9 +44,19 @@ int main( int argc, char** argv ) {
         "-v"
     );
 
+    argparser_add( parser,
+        "set",
+        "key=value overrides",
+        false,
+        1,
+        ARG_TYPE_MAP,       // maps take `key=value` tokens, and are the only type that can be passed more than once
+        "--set",
+        "-s"
+    );
+
     // parse the arguments
+    // if parsing fails the parser has already been freed for you
     if ( argparser_parse( parser, argc, argv ) != 0 ) {
-        argparser_deinit( parser );
         return EXIT_FAILURE;
     }
 
@@ -70,11 +80,83 @@ int main( int argc, char** argv ) {
     // but you'll still want to know if it's there or not
     printf( "%s\n", argparser_get_none( parser, "verbose" ) == argparser_found( parser, "verbose" ) ? "true" : "false" ); // this will print "true"
 
+    // map arguments are looked up by key, e.g. `--set threads=8 --set name=worker`
+    // passing the same key twice is an error, just like redefining any other argument
+    const char* name = argparser_get_map( parser, "set", "name" ); // NULL if the key was never passed
+    printf( "Name: %s\n", name ? name : "(none)" );
+
+    // values can be converted the same way a flag of that type would be
+    arg_value threads;
+    if ( argparser_get_map_as( parser, "set", "threads", ARG_TYPE_U32, &threads ) ) {
+        printf( "Threads: %u\n", threads.u32 );
+    }
+
+    // entries keep the order they were passed in. keys aren't null terminated, so use key_len
+    for ( size_t i = 0; i < argparser_get_map_length( parser, "set" ); i++ ) {
+        const arg_map_entry_t* entry = argparser_get_map_entry( parser, "set", i );
+        printf( "%.*s = %s\n", (int)entry->key_len, entry->key, entry->value );
+    }
+
     // for the rest of your (positional) arguments you can just use the new argc and argv within the argparser_t struct
     for ( int i = 0; i < parser->argc; i++ ) {
         printf( "%s, ", parser->argv[i] );
     }
 
+    // if your program reloads its arguments at runtime, reparse them instead of building a whole new parser.
+    // only the arguments whose tokens actually changed get converted again
+    char count[32];
+    snprintf( count, sizeof( count ), "%llu", (unsigned long long)argparser_get_u64( parser, "count", 0 ) + 1 );
+    char* identifier_0 = argparser_get_str( parser, "identifier", 0 );
+    char* reload[] = {
+        argv[0],
+        "--alias1",
+        argparser_get_str( parser, "identifier", 0 ),
+        argparser_get_str( parser, "identifier", 1 ),
+        argparser_get_str( parser, "identifier", 2 ),
+        argparser_get_str( parser, "identifier", 3 ),
+        "--count",
+        count
+    };
+
+    argparser_changes_t changes;
+    if ( argparser_reparse( parser, sizeof( reload ) / sizeof( reload[0] ), reload, &changes ) == 0 ) {
+        // the change set tells you which arguments changed, along with their old and new values
+        if ( argparser_changed( parser, &changes, "count" ) ) {
+            arg_change_t* change = argparser_get_change( parser, &changes, "count" );
+            printf( "\nCount: %llu -> %llu\n", (unsigned long long)change->old_values[0].u64, (unsigned long long)change->new_values[0].u64 );
+        }
+
+        // unchanged arguments aren't touched at all, so their strings keep the exact same pointer
+        printf( "%s\n", argparser_get_str( parser, "identifier", 0 ) == identifier_0 ? "true" : "false" ); // this will print "true"
+
+        // the old values in a change set only live until the next reparse, so free it before reparsing again
+        argparser_changes_free( &changes );
+    }
+
+    // a failed reparse leaves the parser exactly as it was, unlike argparser_parse which frees it.
+    // you can also pass NULL if you don't care what changed
+    reload[7] = "not a number";
+    if ( argparser_reparse( parser, sizeof( reload ) / sizeof( reload[0] ), reload, NULL ) != 0 ) {
+        printf( "Count: %llu\n", (unsigned long long)argparser_get_u64( parser, "count", 0 ) ); // still the value from the last successful reparse
+    }
+
+    // duplicate map keys are rejected the same way
+    char* duplicate[] = {
+        argv[0],
+        "--alias1",
+        reload[2],
+        reload[3],
+        reload[4],
+        reload[5],
+        "--set",
+        "name=first",
+        "--set",
+        "name=second"
+    };
+    if ( argparser_reparse( parser, sizeof( duplicate ) / sizeof( duplicate[0] ), duplicate, NULL ) != 0 ) {
+        printf( "Set entries: %zu\n", argparser_get_map_length( parser, "set" ) ); // still the entries from the last successful reparse
+    }
+
     // then when you're done with the arguments and have set all the flags you deemed necessary
     argparser_free( parser );
 